@@ -0,0 +1,215 @@
+#include "GameLog.h"
+
+#include <sstream>
+#include <thread>
+#include <algorithm>
+
+ReplayStats::ReplayStats() : games(0), solvedGames(0), inconsistentGames(0), malformedLines(0), guesses(0),
+                             invalidGuesses(0), consistentGuesses(0), solverAgreements(0) {
+}
+
+void ReplayStats::merge(const ReplayStats& other) {
+    games += other.games;
+    solvedGames += other.solvedGames;
+    inconsistentGames += other.inconsistentGames;
+    malformedLines += other.malformedLines;
+    guesses += other.guesses;
+    invalidGuesses += other.invalidGuesses;
+    consistentGuesses += other.consistentGuesses;
+    solverAgreements += other.solverAgreements;
+
+    if (candidatesAfterGuess.size() < other.candidatesAfterGuess.size()) {
+        candidatesAfterGuess.resize(other.candidatesAfterGuess.size(), 0);
+        gamesAfterGuess.resize(other.gamesAfterGuess.size(), 0);
+    }
+    for (size_t step = 0; step < other.candidatesAfterGuess.size(); ++step) {
+        candidatesAfterGuess[step] += other.candidatesAfterGuess[step];
+        gamesAfterGuess[step] += other.gamesAfterGuess[step];
+    }
+}
+
+void ReplayStats::print(ostream& out, double seconds) const {
+    // percentages of zero games are shown as 0
+    auto percent = [](unsigned long part, unsigned long whole) {
+        return whole == 0 ? 0.0 : 100.0 * part / whole;
+    };
+
+    out << "Games: " << games << " | Games per second: " << static_cast<long>(seconds > 0 ? games / seconds : 0)
+        << " | Malformed lines: " << malformedLines << endl;
+    out << "Solved: " << percent(solvedGames, games) << "% | Inconsistent feedback: "
+        << percent(inconsistentGames, games) << "%" << endl;
+    out << "Guesses: " << guesses << " | Not in dictionary: " << percent(invalidGuesses, guesses)
+        << "% | Could be the answer: " << percent(consistentGuesses, guesses)
+        << "% | Same as solver: " << percent(solverAgreements, guesses) << "%" << endl;
+    for (size_t step = 0; step < candidatesAfterGuess.size(); ++step) {
+        out << "Average candidates after guess " << step + 1 << ": "
+            << static_cast<double>(candidatesAfterGuess[step]) / gamesAfterGuess[step] << endl;
+    }
+}
+
+LogReader::LogReader(const vector<string>& files) : files(files), nextFile(0), buffer(CHUNK_SIZE) {
+}
+
+bool LogReader::nextLines(vector<string>& lines) {
+    lines.clear();
+    lock_guard<mutex> guard(lock);
+
+    while (true) {
+        // open the next file when the current one is done
+        if (!current.is_open()) {
+            if (nextFile == files.size()) {
+                return false;
+            }
+            current.open(files[nextFile++], ios::binary);
+            if (!current.is_open()) {
+                cerr << "Can not open " << files[nextFile - 1] << endl;
+                continue;
+            }
+        }
+
+        current.read(buffer.data(), CHUNK_SIZE);
+        size_t length = current.gcount();
+        string text = carry;
+        text.append(buffer.data(), length);
+        carry = "";
+
+        bool fileDone = length < CHUNK_SIZE;
+        if (fileDone) {
+            current.close();
+            current.clear();
+        }
+
+        // the last line of a chunk may continue in the next one, the last line of a file is complete
+        size_t start = 0;
+        size_t end;
+        while ((end = text.find('\n', start)) != string::npos) {
+            lines.push_back(text.substr(start, end - start));
+            start = end + 1;
+        }
+        if (fileDone) {
+            if (start < text.size()) lines.push_back(text.substr(start));
+        } else {
+            carry = text.substr(start);
+        }
+
+        if (!lines.empty()) {
+            return true;
+        }
+    }
+}
+
+GameReplayer::GameReplayer(const SortedWordStore& words, const WordIndex& dictionary)
+        : words(words), dictionary(dictionary), openingHint(0) {
+    size_t best = bestHintIndex(words.packedWords());
+    hasOpeningHint = best < words.packedWords().size();
+    if (hasOpeningHint) {
+        openingHint = words.packedWords()[best];
+    }
+}
+
+void GameReplayer::replay(const string& line) {
+    istringstream fields(line);
+    string answer, guess, pattern;
+
+    // blank lines are skipped
+    if (!(fields >> answer)) return;
+    if (!dictionary.contains(answer)) {
+        stats.malformedLines++;
+        return;
+    }
+    stats.games++;
+
+    // the words that still match the feedback seen so far. They are copied from the shared words
+    // only when the first guess is applied, so the dictionary is read once per game
+    const vector<PackedWord>* current = &words.packedWords();
+    bool consistent = true;
+    size_t step = 0;
+    while (fields >> guess >> pattern) {
+        // the rest of a line with an unreadable guess is skipped
+        if (!isPackable(guess) || pattern.length() != 5) {
+            stats.malformedLines++;
+            break;
+        }
+        stats.guesses++;
+        if (!dictionary.contains(guess)) {
+            stats.invalidGuesses++;
+        }
+
+        // compare the player with the solver before the feedback of this guess is known
+        PackedWord packed = packWord(guess);
+        if (binary_search(current->begin(), current->end(), packed)) {
+            stats.consistentGuesses++;
+        }
+        // the solver suggests the best hint among the remaining candidates
+        bool agrees;
+        if (step == 0) {
+            agrees = hasOpeningHint && openingHint == packed;
+        } else {
+            size_t best = bestHintIndex(*current);
+            agrees = best < current->size() && (*current)[best] == packed;
+        }
+        if (agrees) {
+            stats.solverAgreements++;
+        }
+
+        if (pattern != colorPattern(guess, answer)) {
+            consistent = false;
+        }
+        // a new constraint only removes words, so filtering the previous candidates is enough
+        TrieQuery feedback;
+        feedback.addFeedback(guess, pattern);
+        if (step == 0) {
+            copyMatchingWords(words.packedWords(), feedback, candidates);
+            current = &candidates;
+        } else {
+            filterPackedWords(candidates, feedback);
+        }
+
+        if (stats.candidatesAfterGuess.size() == step) {
+            stats.candidatesAfterGuess.push_back(0);
+            stats.gamesAfterGuess.push_back(0);
+        }
+        stats.candidatesAfterGuess[step] += candidates.size();
+        stats.gamesAfterGuess[step]++;
+        step++;
+
+        if (pattern == "ggggg") {
+            stats.solvedGames++;
+            break;
+        }
+    }
+
+    if (!consistent) {
+        stats.inconsistentGames++;
+    }
+}
+
+ReplayStats replayLogs(const vector<string>& files, const SortedWordStore& words, const WordIndex& dictionary,
+                       unsigned int threadCount) {
+    LogReader reader(files);
+    threadCount = max(1u, threadCount);
+
+    // each thread fills its own statistics, so the replay needs no locking apart from reading
+    // GameReplayer is aligned to a cache line, so one thread's statistics never share a line with another's
+    vector<GameReplayer> replayers(threadCount, GameReplayer(words, dictionary));
+    vector<thread> workers;
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&reader, &replayers, t]() {
+            vector<string> lines;
+            while (reader.nextLines(lines)) {
+                for (const string& line : lines) {
+                    replayers[t].replay(line);
+                }
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    ReplayStats total;
+    for (const GameReplayer& replayer : replayers) {
+        total.merge(replayer.stats);
+    }
+    return total;
+}
@@ -0,0 +1,96 @@
+#ifndef ASSIGNMENT_4_GAMELOG_H
+#define ASSIGNMENT_4_GAMELOG_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <mutex>
+#include <iostream>
+
+#include "Trie.h"
+#include "WordIndex.h"
+#include "WordStore.h"
+
+using namespace std;
+
+//A game log has one played game per line: the answer followed by each guess and the pattern it got,
+//e.g. "wooed krubi bbbbb sword bygby wooed ggggg".
+//Games are replayed against a shared sorted array of packed words and a dictionary index, which are only read.
+//The candidates of a game are kept in a vector that each thread reuses, and each guess is turned into
+//a TrieQuery that removes the words its feedback rules out, so no game ever copies or filters a trie.
+
+//ReplayStats collects the results of replayed games. Every thread fills its own and they are merged at the end.
+class ReplayStats {
+public:
+    unsigned long games;
+    unsigned long solvedGames;
+    //games where a pattern is not the one the answer gives
+    unsigned long inconsistentGames;
+    //lines that could not be read, or whose answer is not in the dictionary
+    unsigned long malformedLines;
+    unsigned long guesses;
+    //guesses that are not in the dictionary
+    unsigned long invalidGuesses;
+    //guesses that could still be the answer after the feedback before them
+    unsigned long consistentGuesses;
+    //guesses equal to the solver's choice, the hint the interactive helper would suggest (bestHintIndex)
+    unsigned long solverAgreements;
+    //candidatesAfterGuess[n] is the sum of candidates left after guess n + 1 over gamesAfterGuess[n] games
+    vector<unsigned long> candidatesAfterGuess;
+    vector<unsigned long> gamesAfterGuess;
+
+    //constructor of empty statistics
+    ReplayStats();
+
+    //adds the statistics of other to these
+    void merge(const ReplayStats& other);
+
+    //prints the statistics, seconds is the time the replay took
+    void print(ostream& out, double seconds) const;
+};
+
+//LogReader reads log files in large chunks and hands out complete lines.
+//Many threads can take lines from the same reader.
+class LogReader {
+private:
+    vector<string> files;
+    size_t nextFile;
+    ifstream current;
+    //end of the last chunk that did not finish with a new line
+    string carry;
+    vector<char> buffer;
+    mutex lock;
+
+    static const size_t CHUNK_SIZE = 1 << 20;
+public:
+    explicit LogReader(const vector<string>& files);
+
+    //replaces lines with the complete lines of the next chunk
+    //returns false when all files are read
+    bool nextLines(vector<string>& lines);
+};
+
+//GameReplayer replays games on one thread and collects their statistics.
+//It takes whole cache lines, so replayers of different threads next to each other do not share one.
+class alignas(64) GameReplayer {
+private:
+    const SortedWordStore& words;
+    const WordIndex& dictionary;
+    //candidates of the game being replayed, reused from game to game
+    vector<PackedWord> candidates;
+    //the solver's first guess, it is the same for every game so it is scored once
+    PackedWord openingHint;
+    bool hasOpeningHint;
+public:
+    ReplayStats stats;
+
+    GameReplayer(const SortedWordStore& words, const WordIndex& dictionary);
+
+    //replays one line of a log and adds its results to stats
+    void replay(const string& line);
+};
+
+//replays all games of the files on threadCount threads and returns the merged statistics
+ReplayStats replayLogs(const vector<string>& files, const SortedWordStore& words, const WordIndex& dictionary,
+                       unsigned int threadCount);
+#endif
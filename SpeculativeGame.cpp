@@ -0,0 +1,152 @@
+#include "SpeculativeGame.h"
+
+#include <algorithm>
+
+SpeculativeGame::SpeculativeGame(const SortedWordStore& words, const WordIndex* dictionary,
+                                 unsigned int speculationCount)
+        : candidates(words), dictionary(dictionary), speculationCount(speculationCount), hits(0) {
+    currentHint = scoreHint(candidates.packedWords(), nullptr);
+}
+
+SpeculativeGame::~SpeculativeGame() {
+    cancelSpeculation();
+}
+
+void SpeculativeGame::cancelSpeculation() {
+    if (cancelled) {
+        cancelled->store(true);
+    }
+    if (speculation.valid()) {
+        // the task checks the flag often, so this wait is short
+        speculation.wait();
+        speculation = future<Speculation>();
+    }
+    cancelled.reset();
+}
+
+string SpeculativeGame::scoreHint(const vector<PackedWord>& words, const atomic<bool>* cancelled) {
+    size_t best = bestHintIndex(words, cancelled);
+    return best == words.size() ? "" : unpackWord(words[best]);
+}
+
+SpeculativeGame::Speculation SpeculativeGame::speculate(vector<PackedWord> words, string guess, unsigned int count,
+                                                        shared_ptr<atomic<bool>> cancelled) {
+    Speculation result;
+
+    // a pattern is a number in base 3: b = 0, y = 1, g = 2
+    const int PATTERNS = 243;
+    unsigned int guessLetters[5];
+    for (int i = 0; i < 5; ++i) {
+        guessLetters[i] = guess[i] - 'a';
+    }
+
+    // group the words by the pattern they would give, sorted order is kept inside each group
+    vector<vector<PackedWord>> groups(PATTERNS);
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        if ((idx & 255) == 0 && cancelled->load()) return result;
+        PackedWord word = words[idx];
+        uint32_t contains = 0;
+        for (int i = 0; i < 5; ++i) {
+            contains |= 1u << packedLetter(word, i);
+        }
+        int code = 0;
+        for (int i = 4; i >= 0; --i) {
+            int digit = 0;
+            if (packedLetter(word, i) == guessLetters[i]) digit = 2;
+            else if (contains & (1u << guessLetters[i])) digit = 1;
+            code = code * 3 + digit;
+        }
+        groups[code].push_back(word);
+    }
+
+    // the largest groups are the most likely patterns
+    vector<int> order;
+    for (int code = 0; code < PATTERNS; ++code) {
+        if (!groups[code].empty()) order.push_back(code);
+    }
+    sort(order.begin(), order.end(), [&groups](int a, int b) { return groups[a].size() > groups[b].size(); });
+
+    // all groups are kept, so any real pattern can be answered without filtering
+    for (int code : order) {
+        string pattern(5, 'b');
+        int rest = code;
+        for (int i = 0; i < 5; ++i) {
+            int digit = rest % 3;
+            rest /= 3;
+            if (digit == 2) pattern[i] = 'g';
+            else if (digit == 1) pattern[i] = 'y';
+        }
+        result.patterns.push_back(pattern);
+        result.candidates.push_back(std::move(groups[code]));
+    }
+
+    // only the likely groups get their hint scored before the pattern is known
+    for (size_t idx = 0; idx < result.candidates.size() && idx < count; ++idx) {
+        string hint = scoreHint(result.candidates[idx], cancelled.get());
+        if (cancelled->load()) return result;
+        result.hints.push_back(hint);
+    }
+    result.complete = true;
+    return result;
+}
+
+string SpeculativeGame::hint() const {
+    return currentHint;
+}
+
+bool SpeculativeGame::guess(const string& word) {
+    if (!isPackable(word)) return false;
+    if (dictionary != nullptr && !dictionary->contains(word)) return false;
+
+    // a new guess replaces the previous one
+    cancelSpeculation();
+    pendingGuess = word;
+    cancelled = make_shared<atomic<bool>>(false);
+    speculation = async(launch::async, &SpeculativeGame::speculate, candidates.packedWords(), word,
+                        speculationCount, cancelled);
+    return true;
+}
+
+bool SpeculativeGame::feedback(const string& pattern) {
+    // filter would treat any other letter as no constraint, so a typo would silently drop one
+    if (pendingGuess.empty() || pattern.length() != 5 || pattern.find_first_not_of("gyb") != string::npos) {
+        return false;
+    }
+
+    // use the background result only if it is already finished
+    bool used = false;
+    if (speculation.valid() && speculation.wait_for(chrono::seconds(0)) == future_status::ready) {
+        Speculation result = speculation.get();
+        if (result.complete) {
+            // a pattern without a group is given by no candidate
+            candidates = SortedWordStore();
+            currentHint = "";
+            for (size_t idx = 0; idx < result.patterns.size(); ++idx) {
+                if (result.patterns[idx] == pattern) {
+                    candidates = SortedWordStore(result.candidates[idx]);
+                    currentHint = idx < result.hints.size() ? result.hints[idx]
+                                                            : scoreHint(candidates.packedWords(), nullptr);
+                    break;
+                }
+            }
+            used = true;
+            hits++;
+        }
+    }
+    cancelSpeculation();
+
+    if (!used) {
+        candidates.filter(pendingGuess, pattern);
+        currentHint = scoreHint(candidates.packedWords(), nullptr);
+    }
+    pendingGuess = "";
+    return true;
+}
+
+unsigned int SpeculativeGame::size() const {
+    return candidates.size();
+}
+
+int SpeculativeGame::speculationHits() const {
+    return hits;
+}
@@ -0,0 +1,89 @@
+#ifndef ASSIGNMENT_4_SPECULATIVEGAME_H
+#define ASSIGNMENT_4_SPECULATIVEGAME_H
+
+#include <string>
+#include <vector>
+#include <future>
+#include <atomic>
+#include <memory>
+
+#include "WordStore.h"
+#include "WordIndex.h"
+
+using namespace std;
+
+//SpeculativeGame drives an interactive game and uses the time the player spends thinking.
+//As soon as a guess is submitted, a background task splits the candidates by the pattern
+//each of them would produce. The candidates that give one pattern are exactly the words
+//that filter(guess, pattern) keeps, so the largest groups are the most likely filter results.
+//Every group is kept, together they hold each candidate once. For the largest groups the next hint
+//is scored in the background as well.
+//When the real pattern arrives and the background work is finished, its group is used right away
+//and only a hint that was not scored yet is computed. Otherwise the background work is cancelled
+//with a flag and the candidates are filtered directly.
+class SpeculativeGame {
+private:
+    //friendly class for testing
+    friend class TrieTest;
+
+    //background result for one guess, the groups are sorted from the largest to the smallest
+    //hints has an entry only for the first speculationCount groups
+    //complete is false if the task was cancelled before it finished
+    struct Speculation {
+        vector<string> patterns;
+        vector<vector<PackedWord>> candidates;
+        vector<string> hints;
+        bool complete = false;
+    };
+
+    SortedWordStore candidates;
+    const WordIndex* dictionary;
+    unsigned int speculationCount;
+    string currentHint;
+    string pendingGuess;
+    int hits;
+
+    //background task of the pending guess and its cancel flag
+    future<Speculation> speculation;
+    shared_ptr<atomic<bool>> cancelled;
+
+    //splits words by the pattern they give for guess and scores the hints of the largest count groups
+    static Speculation speculate(vector<PackedWord> words, string guess, unsigned int count,
+                                 shared_ptr<atomic<bool>> cancelled);
+
+    //returns the word bestHintIndex picks, empty string if there is none or the task was cancelled
+    static string scoreHint(const vector<PackedWord>& words, const atomic<bool>* cancelled);
+
+    //stops the background task of the pending guess and waits for it to return
+    void cancelSpeculation();
+public:
+    //words are the candidates of a new game
+    //if a dictionary is given, guesses that are not in it are rejected
+    explicit SpeculativeGame(const SortedWordStore& words, const WordIndex* dictionary = nullptr,
+                             unsigned int speculationCount = 4);
+
+    //cancels the background work
+    ~SpeculativeGame();
+
+    SpeculativeGame(const SpeculativeGame&) = delete;
+    SpeculativeGame& operator=(const SpeculativeGame&) = delete;
+
+    //returns the suggested next guess, empty string if no candidates are left
+    string hint() const;
+
+    //submits the player's guess and starts the background work for it
+    //returns false if the guess is not 5 letters or not in the dictionary
+    bool guess(const string& word);
+
+    //applies the pattern shown for the pending guess
+    //returns false and keeps the guess pending if there is no pending guess,
+    //or pattern is not 5 letters each of them g, y or b
+    bool feedback(const string& pattern);
+
+    //returns the number of candidates left
+    unsigned int size() const;
+
+    //returns how many feedbacks were answered from a finished background result without filtering
+    int speculationHits() const;
+};
+#endif
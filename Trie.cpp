@@ -1,10 +1,14 @@
 #include "Trie.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 // trie_counter should be incremented by one after
 // each word is checked in the 'filter' function.
 int trie_counter = 0;
 
-TrieNode::TrieNode() {
+TrieNode::TrieNode() : maxWeight(-std::numeric_limits<double>::infinity()) {
 }
 
 Trie::Trie() {
@@ -68,13 +72,15 @@ unsigned int Trie::size() const {
     return countLeaves((root));
 }
 
-bool Trie::insert(const std::string &word) {
+bool Trie::insert(const std::string &word, double weight) {
     // inserts word
 
     // word must be 5 letters
     if (word.length() != 5) return false;
 
     TrieNode* current = root;
+    // nodes on the path of the word, their maxWeight is raised once the word is inserted
+    TrieNode* path[6] = {root};
     int i = 0;
 
     // traverse through all the existing nodes to check if there's a prefix match
@@ -82,10 +88,12 @@ bool Trie::insert(const std::string &word) {
         char c = word[i];
 
         // if the child doesn't exist, break to insert
-        if (current->children.count(c) == 0) {
+        unordered_map<char, TrieNode*>::iterator it = current->children.find(c);
+        if (it == current->children.end()) {
             break;
         }
-        current = current->children[c];
+        current = it->second;
+        path[i + 1] = current;
     }
 
     // if the whole word is traversed then the prefix exists
@@ -96,14 +104,36 @@ bool Trie::insert(const std::string &word) {
 
     // insert the remaining letters
     for (; i < 5; ++i) {
-        char c = word[i];
-        current->children[c] = new TrieNode();
-        current = current->children[c];
+        TrieNode* child = new TrieNode();
+        current->children.emplace(word[i], child);
+        current = child;
+        path[i + 1] = current;
+    }
+
+    for (TrieNode* node : path) {
+        node->maxWeight = std::max(node->maxWeight, weight);
     }
 
     return true;
 }
 
+bool Trie::contains(const std::string &word) const {
+    // checks if word is in the trie
+
+    // word must be 5 letters
+    if (word.length() != 5) return false;
+
+    const TrieNode* current = root;
+    for (int i = 0; i < 5; ++i) {
+        unordered_map<char, TrieNode*>::const_iterator it = current->children.find(word[i]);
+        if (it == current->children.end()) {
+            return false;
+        }
+        current = it->second;
+    }
+    return true;
+}
+
 std::string Trie::getFirstWord() {
     // return the first word in trie
 
@@ -252,6 +282,218 @@ void Trie::filterRecursively(TrieNode* node, std::string currentWord, const std:
         }
         ++it;
     }
+
+    // words below this node may have been deleted, take the max of the remaining children again
+    node->maxWeight = -std::numeric_limits<double>::infinity();
+    for (auto& child : node->children) {
+        node->maxWeight = std::max(node->maxWeight, child.second->maxWeight);
+    }
+}
+
+std::list<std::string> Trie::topK(unsigned int k) const {
+    std::vector<std::pair<double, std::string>> best;
+    std::string currentWord;
+    if (k > 0) {
+        topKRecursively(root, currentWord, k, best);
+    }
+
+    // best is a min-heap, sort_heap with the same comparison puts the largest weight first
+    std::sort_heap(best.begin(), best.end(), std::greater<std::pair<double, std::string>>());
+    std::list<std::string> words;
+    for (const auto& entry : best) {
+        words.push_back(entry.second);
+    }
+    return words;
+}
+
+void Trie::topKRecursively(TrieNode *node, std::string &currentWord, unsigned int k,
+                           std::vector<std::pair<double, std::string>> &best) const {
+    std::greater<std::pair<double, std::string>> minHeap;
+
+    // base case - full word
+    if (currentWord.size() == 5) {
+        if (best.size() < k) {
+            best.emplace_back(node->maxWeight, currentWord);
+            std::push_heap(best.begin(), best.end(), minHeap);
+        } else if (node->maxWeight > best.front().first) {
+            std::pop_heap(best.begin(), best.end(), minHeap);
+            best.back() = std::make_pair(node->maxWeight, currentWord);
+            std::push_heap(best.begin(), best.end(), minHeap);
+        }
+        return;
+    }
+
+    // visit the heaviest children first, so the heap fills with good words early and more is pruned
+    std::vector<std::pair<char, TrieNode*>> children(node->children.begin(), node->children.end());
+    std::stable_sort(children.begin(), children.end(),
+                     [](const std::pair<char, TrieNode*>& a, const std::pair<char, TrieNode*>& b) {
+                         return a.second->maxWeight > b.second->maxWeight;
+                     });
+
+    for (auto& child : children) {
+        // no word below this child can beat the k-th best word
+        if (best.size() == k && child.second->maxWeight <= best.front().first) {
+            break;
+        }
+        currentWord.push_back(child.first);
+        topKRecursively(child.second, currentWord, k, best);
+        currentWord.pop_back();
+    }
+}
+
+std::string Trie::getBestWord() const {
+    std::list<std::string> words = topK(1);
+    return words.empty() ? "" : words.front();
+}
+
+TrieQuery::TrieQuery() {
+    for (int i = 0; i < 5; ++i) {
+        allowed[i] = (1u << 26) - 1;
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+        minCount[letter] = 0;
+        maxCount[letter] = 5;
+    }
+}
+
+bool TrieQuery::setPositions(const std::string &mask) {
+    // check the whole mask first, so an invalid mask changes nothing
+    if (mask.length() != 5) return false;
+    for (char c : mask) {
+        if (c != '?' && (c < 'a' || c > 'z')) return false;
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        if (mask[i] != '?') {
+            allowed[i] &= 1u << (mask[i] - 'a');
+        }
+    }
+    return true;
+}
+
+void TrieQuery::mustContain(char letter, unsigned int count) {
+    if (letter < 'a' || letter > 'z') return;
+    unsigned char& least = minCount[letter - 'a'];
+    least = std::max<unsigned int>(least, std::min(count, 5u));
+}
+
+void TrieQuery::mustNotContain(char letter) {
+    if (letter < 'a' || letter > 'z') return;
+    maxCount[letter - 'a'] = 0;
+}
+
+void TrieQuery::notAt(int position, char letter) {
+    if (position < 0 || position > 4 || letter < 'a' || letter > 'z') return;
+    allowed[position] &= ~(1u << (letter - 'a'));
+}
+
+bool TrieQuery::addFeedback(const std::string &guess, const std::string &pattern) {
+    if (guess.length() != 5 || pattern.length() != 5) {
+        return false;
+    }
+    for (char c : guess) {
+        if (c < 'a' || c > 'z') return false;
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        if (pattern[i] == 'g') {
+            // only this letter can be at this position
+            allowed[i] &= 1u << (guess[i] - 'a');
+        } else if (pattern[i] == 'y') {
+            // the letter is in the word but not here
+            notAt(i, guess[i]);
+            mustContain(guess[i]);
+        } else if (pattern[i] == 'b') {
+            mustNotContain(guess[i]);
+        }
+    }
+    return true;
+}
+
+bool TrieQuery::matches(const std::string &word) const {
+    if (word.length() != 5) return false;
+
+    unsigned char counts[26] = {0};
+    for (int i = 0; i < 5; ++i) {
+        char c = word[i];
+        if (c < 'a' || c > 'z' || !(allowed[i] & (1u << (c - 'a')))) {
+            return false;
+        }
+        counts[c - 'a']++;
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+        if (counts[letter] < minCount[letter] || counts[letter] > maxCount[letter]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned int Trie::query(const TrieQuery &query, const std::function<bool(const std::string&)> &visit) const {
+    unsigned char counts[26] = {0};
+    int missing = 0;
+    for (int letter = 0; letter < 26; ++letter) {
+        missing += query.minCount[letter];
+    }
+
+    unsigned int found = 0;
+    std::string currentWord;
+    queryRecursively(root, currentWord, counts, missing, query, &visit, found);
+    return found;
+}
+
+unsigned int Trie::count(const TrieQuery &query) const {
+    unsigned char counts[26] = {0};
+    int missing = 0;
+    for (int letter = 0; letter < 26; ++letter) {
+        missing += query.minCount[letter];
+    }
+
+    unsigned int found = 0;
+    std::string currentWord;
+    queryRecursively(root, currentWord, counts, missing, query, nullptr, found);
+    return found;
+}
+
+bool Trie::queryRecursively(const TrieNode *node, std::string &currentWord, unsigned char counts[26], int missing,
+                            const TrieQuery &query, const std::function<bool(const std::string&)> *visit,
+                            unsigned int &found) const {
+    int depth = currentWord.size();
+
+    // base case - full word, all the checks were done on the way down
+    if (depth == 5) {
+        found++;
+        return visit == nullptr || (*visit)(currentWord);
+    }
+
+    // recursive case - only go into children that can still lead to a matching word
+    for (const auto& child : node->children) {
+        char c = child.first;
+        if (c < 'a' || c > 'z') continue;
+        int letter = c - 'a';
+
+        // letter not allowed here, or already used as often as allowed
+        if (!(query.allowed[depth] & (1u << letter)) || counts[letter] >= query.maxCount[letter]) {
+            continue;
+        }
+
+        // the positions after this one must be enough for the letters that are still missing
+        int stillMissing = missing - (counts[letter] < query.minCount[letter] ? 1 : 0);
+        if (stillMissing > 4 - depth) {
+            continue;
+        }
+
+        counts[letter]++;
+        currentWord.push_back(c);
+        bool keepGoing = queryRecursively(child.second, currentWord, counts, stillMissing, query, visit, found);
+        currentWord.pop_back();
+        counts[letter]--;
+
+        if (!keepGoing) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void Trie::print() {
@@ -4,20 +4,66 @@
 #include <string>
 #include <unordered_map>
 #include<list>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cstdint>
 #include <iostream>
 
 using namespace std;
 
+// trie_counter is defined in Trie.cpp and incremented by the 'filter' function.
+extern int trie_counter;
+
 class TrieNode {
 public:
     //children of a current node. There can be up to 26 children in accordance with 26 letters in English alphabet.
     //unordered_map has keys (letters) and values (TrieNode pointers)
     //if the letter is the end of the word then it does not have children
     unordered_map<char, TrieNode*> children;
+    //the largest weight of a word below this node. For a leaf it is the weight of its word.
+    //a node without words below it has -infinity, so negative weights (e.g. log frequencies) keep their order
+    //filter keeps it exact, it never drops below the real maximum, so it can be used to skip whole subtrees
+    double maxWeight;
     //constructor of a TrieNode.
     TrieNode();
 };
 
+//TrieQuery describes the words a read-only query on the trie matches.
+//Each position has a mask of allowed letters and each letter has a smallest and largest count.
+//Only the letters 'a' to 'z' are known, words with other characters never match.
+class TrieQuery {
+public:
+    //bit i of allowed[p] is set if letter 'a' + i may be at position p
+    uint32_t allowed[5];
+    //how many times each letter must appear at least and at most
+    unsigned char minCount[26];
+    unsigned char maxCount[26];
+
+    //constructor of a query that matches every word
+    TrieQuery();
+
+    //sets the letters of the positions, e.g. "s?i?e". '?' keeps the position as it is
+    //returns false and changes nothing if mask is not 5 characters of 'a' - 'z' or '?'
+    bool setPositions(const string& mask);
+
+    //the word must have letter at least count times
+    void mustContain(char letter, unsigned int count = 1);
+
+    //the word must not have letter at all
+    void mustNotContain(char letter);
+
+    //letter must not be at position
+    void notAt(int position, char letter);
+
+    //adds the constraints of a guess and its pattern with the same rules as Trie::filter
+    //returns false and changes nothing if length of inputs is not 5 or guess has other characters than 'a' - 'z'
+    bool addFeedback(const string& guess, const string& pattern);
+
+    //returns true if word matches the query
+    bool matches(const string& word) const;
+};
+
 class Trie {
 private:
     // It is not a beginning of any word, but all its children are the beginnings of words
@@ -38,6 +84,18 @@ private:
 
     //getWordsRecursively function builds strings of the words from the Trie object
     void getWordsRecursively(TrieNode* node, std::string currentWord, std::list<std::string>& words) const;
+
+    //topKRecursively visits children with the largest maxWeight first and keeps the k best words in a min-heap.
+    //a child is skipped when its maxWeight can not beat the k-th best word found so far
+    void topKRecursively(TrieNode* node, std::string& currentWord, unsigned int k,
+                         std::vector<std::pair<double, std::string>>& best) const;
+
+    //queryRecursively walks down only the letters allowed by the query and stops at a node when
+    //a letter is used too often or the remaining positions can not hold the letters still missing (missing).
+    //visit may be null when only the count is needed. Returns false once visit asks to stop.
+    bool queryRecursively(const TrieNode* node, std::string& currentWord, unsigned char counts[26], int missing,
+                          const TrieQuery& query, const std::function<bool(const std::string&)>* visit,
+                          unsigned int& found) const;
 public:
     //constructor of a Trie
     Trie();
@@ -53,7 +111,12 @@ public:
     //returns true if successful
     //returns false if word is already in the trie
     //returns false if length of word is not 5
-    bool insert(const string& word);
+    //weight is the frequency or prior of the word, words with larger weight are more likely answers
+    bool insert(const string& word, double weight = 1.0);
+
+    //returns true if word is in the trie
+    //walks down one letter at a time, so it takes O(word length)
+    bool contains(const string& word) const;
 
     //function calls getWordsRecursively and returns all words kept in the trie
     list<string> getAllWords() const;
@@ -70,6 +133,21 @@ public:
     // if no words are in trie, return empty string
     string getFirstWord();
 
+    //returns up to k words with the largest weights, the most likely word first
+    //only subtrees whose maxWeight can beat the k-th best word are visited
+    list<string> topK(unsigned int k) const;
+
+    //returns the word with the largest weight, or empty string if no words are in trie
+    string getBestWord() const;
+
+    //calls visit for every word that matches the query, without changing the trie.
+    //visit returns false to stop early. Returns the number of words visited.
+    //the trie is only read, so many threads can query it at the same time
+    unsigned int query(const TrieQuery& query, const function<bool(const string&)>& visit) const;
+
+    //returns the number of words that match the query
+    unsigned int count(const TrieQuery& query) const;
+
     //helper function that prints a trie
     void print();
 };
@@ -0,0 +1,37 @@
+#include "WordIndex.h"
+
+int32_t WordIndex::wordNumber(const string& word) {
+    if (word.length() != 5) return -1;
+    int32_t number = 0;
+    for (int i = 0; i < 5; ++i) {
+        char c = word[i];
+        if (c < 'a' || c > 'z') return -1;
+        number = number * 26 + (c - 'a');
+    }
+    return number;
+}
+
+WordIndex::WordIndex(const list<string>& words) : bits((WORD_SPACE + 63) / 64, 0), count(0) {
+    for (const string& word : words) {
+        int32_t number = wordNumber(word);
+        if (number < 0) continue;
+
+        uint64_t bit = uint64_t(1) << (number & 63);
+        uint64_t& block = bits[number >> 6];
+        // count each word once even if the dictionary repeats it
+        if ((block & bit) == 0) {
+            block |= bit;
+            count++;
+        }
+    }
+}
+
+bool WordIndex::contains(const string& word) const {
+    int32_t number = wordNumber(word);
+    if (number < 0) return false;
+    return (bits[number >> 6] >> (number & 63)) & 1;
+}
+
+unsigned int WordIndex::size() const {
+    return count;
+}
@@ -0,0 +1,36 @@
+#ifndef ASSIGNMENT_4_WORDINDEX_H
+#define ASSIGNMENT_4_WORDINDEX_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+//WordIndex answers "is this word in the dictionary" with a single bit lookup.
+//Every 5-letter lowercase word has a number from 0 to 26^5 - 1 (the letters are digits in base 26),
+//and the index keeps one bit per number, which is about 1.5 MB.
+//The index is built once in the constructor and never changes afterwards,
+//so any number of threads can call contains at the same time.
+class WordIndex {
+private:
+    vector<uint64_t> bits;
+    unsigned int count;
+
+    //returns the number of a word in base 26, or -1 if the word is not 5 lowercase letters
+    static int32_t wordNumber(const string& word);
+public:
+    //number of different 5-letter lowercase words
+    static const uint32_t WORD_SPACE = 26 * 26 * 26 * 26 * 26;
+
+    //builds the index from the words of the dictionary, words that are not 5 lowercase letters are skipped
+    explicit WordIndex(const list<string>& words);
+
+    //returns true if word is in the dictionary
+    bool contains(const string& word) const;
+
+    //returns the number of different words in the index
+    unsigned int size() const;
+};
+#endif
@@ -0,0 +1,418 @@
+#include "WordStore.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+int list_counter = 0;
+int sorted_counter = 0;
+
+string colorPattern(const string& guess, const string& target) {
+    // compare the guess and target word to determine the color code
+    string colors = "";
+    for (int i = 0; i < 5; ++i) {
+        if (guess[i] == target[i]) {
+            colors += 'g'; // Green
+        } else if (target.find(guess[i]) != string::npos) {
+            colors += 'y'; // Yellow
+        } else {
+            colors += 'b'; // Grey
+        }
+    }
+    return colors;
+}
+
+bool matchesPattern(const string& word, const string& guess, const string& pattern) {
+    for (int i = 0; i < 5; ++i) {
+        if (pattern[i] == 'g' && word[i] != guess[i]) { // Green - correct position
+            return false;
+        } else if (pattern[i] == 'y') { // Yellow - correct letter, wrong position
+            if (word[i] == guess[i] || word.find(guess[i]) == string::npos) {
+                return false;
+            }
+        } else if (pattern[i] == 'b' && word.find(guess[i]) != string::npos) { // Grey - letter not in word
+            return false;
+        }
+    }
+    return true;
+}
+
+list<string> filterWordList(const list<string>& wordList, const string& guess, const string& colors) {
+    list<string> filteredWords;
+
+    for (const auto& word : wordList) {
+        list_counter ++;
+        if (matchesPattern(word, guess, colors)) {
+            filteredWords.push_back(word);
+        }
+    }
+    return filteredWords;
+}
+
+bool isPackable(const string& word) {
+    if (word.length() != 5) return false;
+    for (char c : word) {
+        if (c < 'a' || c > 'z') return false;
+    }
+    return true;
+}
+
+PackedWord packWord(const string& word) {
+    PackedWord packed = 0;
+    for (int i = 0; i < 5; ++i) {
+        packed = (packed << 5) | static_cast<PackedWord>(word[i] - 'a');
+    }
+    return packed;
+}
+
+string unpackWord(PackedWord packed) {
+    string word(5, ' ');
+    for (int i = 0; i < 5; ++i) {
+        word[i] = static_cast<char>('a' + packedLetter(packed, i));
+    }
+    return word;
+}
+
+PackedMatcher::PackedMatcher(const TrieQuery& query) : needed(0), banned(0), countedLetters(0) {
+    for (int i = 0; i < 5; ++i) {
+        allowed[i] = query.allowed[i];
+    }
+    for (int letter = 0; letter < 26; ++letter) {
+        minCount[letter] = query.minCount[letter];
+        maxCount[letter] = query.maxCount[letter];
+        if (minCount[letter] > 0) needed |= 1u << letter;
+        if (maxCount[letter] == 0) banned |= 1u << letter;
+        if (minCount[letter] > 1 || (maxCount[letter] > 0 && maxCount[letter] < 5)) {
+            counted[countedLetters++] = letter;
+        }
+    }
+}
+
+void filterPackedWords(vector<PackedWord>& words, const TrieQuery& query) {
+    PackedMatcher matcher(query);
+    size_t kept = 0;
+    for (PackedWord packed : words) {
+        if (matcher.matches(packed)) {
+            words[kept++] = packed;
+        }
+    }
+    words.resize(kept);
+}
+
+void copyMatchingWords(const vector<PackedWord>& from, const TrieQuery& query, vector<PackedWord>& to) {
+    PackedMatcher matcher(query);
+    to.clear();
+    for (PackedWord packed : from) {
+        if (matcher.matches(packed)) {
+            to.push_back(packed);
+        }
+    }
+}
+
+size_t bestHintIndex(const vector<PackedWord>& words, const atomic<bool>* cancelled) {
+    // count in how many words each letter appears
+    unsigned int frequency[26] = {0};
+    vector<uint32_t> letterMasks(words.size());
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        if (cancelled && (idx & 255) == 0 && cancelled->load()) return words.size();
+        uint32_t mask = 0;
+        for (int i = 0; i < 5; ++i) {
+            mask |= 1u << packedLetter(words[idx], i);
+        }
+        letterMasks[idx] = mask;
+        for (int letter = 0; letter < 26; ++letter) {
+            if (mask & (1u << letter)) frequency[letter]++;
+        }
+    }
+
+    // the best hint covers the most common letters, repeated letters are counted once
+    size_t best = 0;
+    unsigned int bestScore = 0;
+    for (size_t idx = 0; idx < words.size(); ++idx) {
+        if (cancelled && (idx & 255) == 0 && cancelled->load()) return words.size();
+        unsigned int score = 0;
+        for (int letter = 0; letter < 26; ++letter) {
+            if (letterMasks[idx] & (1u << letter)) score += frequency[letter];
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            best = idx;
+        }
+    }
+    return words.empty() ? words.size() : best;
+}
+
+void WordStore::load(const list<string>& words) {
+    for (const string& word : words) {
+        insert(word);
+    }
+}
+
+string WordStore::getBestWord() {
+    return getFirstWord();
+}
+
+// TrieWordStore
+
+TrieWordStore::TrieWordStore(Trie& trie) : trie(trie) {
+}
+
+bool TrieWordStore::insert(const string& word, double weight) {
+    return trie.insert(word, weight);
+}
+
+bool TrieWordStore::filter(const string& guess, const string& pattern) {
+    return trie.filter(guess, pattern);
+}
+
+unsigned int TrieWordStore::size() const {
+    return trie.size();
+}
+
+string TrieWordStore::getFirstWord() {
+    return trie.getFirstWord();
+}
+
+string TrieWordStore::getBestWord() {
+    return trie.getBestWord();
+}
+
+void TrieWordStore::forEach(const function<void(const string&)>& visit) const {
+    for (const string& word : trie.getAllWords()) {
+        visit(word);
+    }
+}
+
+int TrieWordStore::wordsChecked() const {
+    return trie_counter;
+}
+
+string TrieWordStore::name() const {
+    return "Trie";
+}
+
+// ListWordStore
+
+ListWordStore::ListWordStore() {
+}
+
+ListWordStore::ListWordStore(const list<string>& words) : words(words) {
+}
+
+bool ListWordStore::insert(const string& word, double) {
+    if (word.length() != 5) return false;
+    if (find(words.begin(), words.end(), word) != words.end()) return false;
+    words.push_back(word);
+    return true;
+}
+
+void ListWordStore::load(const list<string>& batch) {
+    words.insert(words.end(), batch.begin(), batch.end());
+
+    // one pass with a set instead of a linear search per word, the order of the list is kept
+    unordered_set<string> seen;
+    for (list<string>::iterator it = words.begin(); it != words.end();) {
+        if (it->length() != 5 || !seen.insert(*it).second) {
+            it = words.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ListWordStore::filter(const string& guess, const string& pattern) {
+    if (guess.length() != 5 || pattern.length() != 5) {
+        return false;
+    }
+    words = filterWordList(words, guess, pattern);
+    return true;
+}
+
+unsigned int ListWordStore::size() const {
+    return words.size();
+}
+
+string ListWordStore::getFirstWord() {
+    return words.empty() ? "" : words.front();
+}
+
+void ListWordStore::forEach(const function<void(const string&)>& visit) const {
+    for (const string& word : words) {
+        visit(word);
+    }
+}
+
+int ListWordStore::wordsChecked() const {
+    return list_counter;
+}
+
+string ListWordStore::name() const {
+    return "List";
+}
+
+// SortedWordStore
+
+SortedWordStore::SortedWordStore() {
+}
+
+SortedWordStore::SortedWordStore(const vector<PackedWord>& sortedWords) : words(sortedWords) {
+}
+
+void SortedWordStore::prefixRange(PackedWord prefix, int prefixLength, size_t& first, size_t& last) const {
+    // all words with the prefix lie between the prefix followed by 'a's and the prefix followed by 'z's
+    int shift = 5 * (5 - prefixLength);
+    PackedWord low = prefix << shift;
+    PackedWord high = low | ((PackedWord(1) << shift) - 1);
+    first = lower_bound(words.begin(), words.end(), low) - words.begin();
+    last = upper_bound(words.begin() + first, words.end(), high) - words.begin();
+}
+
+bool SortedWordStore::insert(const string& word, double) {
+    // only 5 lowercase letters can be packed
+    if (!isPackable(word)) return false;
+
+    PackedWord packed = packWord(word);
+    vector<PackedWord>::iterator it = lower_bound(words.begin(), words.end(), packed);
+    if (it != words.end() && *it == packed) {
+        // word already exists
+        return false;
+    }
+    words.insert(it, packed);
+    return true;
+}
+
+void SortedWordStore::load(const list<string>& batch) {
+    words.reserve(words.size() + batch.size());
+    for (const string& word : batch) {
+        if (isPackable(word)) {
+            words.push_back(packWord(word));
+        }
+    }
+    // sort once and drop duplicates
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+}
+
+bool SortedWordStore::filter(const string& guess, const string& pattern) {
+    if (guess.length() != 5 || pattern.length() != 5) {
+        return false;
+    }
+
+    // translate the feedback into a query. A green or yellow character that is not a letter
+    // can not be in any packed word, a grey one rules nothing out
+    TrieQuery query;
+    string positions = "?????";
+    for (int i = 0; i < 5; ++i) {
+        char c = guess[i];
+        bool letter = c >= 'a' && c <= 'z';
+        if ((pattern[i] == 'g' || pattern[i] == 'y') && !letter) {
+            words.clear();
+            return true;
+        }
+        if (pattern[i] == 'g') {
+            positions[i] = c;
+        } else if (pattern[i] == 'y') {
+            query.notAt(i, c);
+            query.mustContain(c);
+        } else if (pattern[i] == 'b') {
+            query.mustNotContain(c);
+        }
+    }
+    query.setPositions(positions);
+
+    // leading green letters are a known prefix, the matching words are a single range
+    int prefixLength = 0;
+    PackedWord prefix = 0;
+    while (prefixLength < 5 && positions[prefixLength] != '?') {
+        prefix = (prefix << 5) | static_cast<PackedWord>(positions[prefixLength] - 'a');
+        prefixLength++;
+    }
+    size_t first = 0;
+    size_t last = words.size();
+    if (prefixLength > 0) {
+        prefixRange(prefix, prefixLength, first, last);
+    }
+
+    // compact the matching words of the range to the front of the array
+    PackedMatcher matcher(query);
+    size_t kept = 0;
+    for (size_t idx = first; idx < last; ++idx) {
+        sorted_counter++;
+        if (matcher.matches(words[idx])) {
+            words[kept++] = words[idx];
+        }
+    }
+    words.resize(kept);
+    return true;
+}
+
+unsigned int SortedWordStore::size() const {
+    return words.size();
+}
+
+string SortedWordStore::getFirstWord() {
+    return words.empty() ? "" : unpackWord(words.front());
+}
+
+void SortedWordStore::forEach(const function<void(const string&)>& visit) const {
+    for (PackedWord packed : words) {
+        visit(unpackWord(packed));
+    }
+}
+
+int SortedWordStore::wordsChecked() const {
+    return sorted_counter;
+}
+
+string SortedWordStore::name() const {
+    return "Sorted array";
+}
+
+const vector<PackedWord>& SortedWordStore::packedWords() const {
+    return words;
+}
+
+bool StoreGamePlay(const string& targetWord, const string& firstGuess, WordStore& store,
+                   const WordIndex* dictionary, bool verbose) {
+    int attempts = 0;
+    if (verbose) {
+        cout << "first guess: " << firstGuess << endl;
+    }
+
+    // an invalid first guess gives no information, so it never reaches filter
+    if (dictionary != nullptr && !dictionary->contains(firstGuess)) {
+        cout << "Using a " << store.name() << ", the guess \"" << firstGuess << "\" is not a valid word." << endl;
+        return false;
+    }
+
+    string guess, colors;
+    while (true) {
+        attempts++;
+        if (attempts == 1) {
+            guess = firstGuess;
+        } else {
+            guess = store.getBestWord(); // The programs' guess is the best word in the store
+            if (verbose) {
+                cout << guess << endl;
+                cout << "Guess: " << guess << " | Colors: " << colors << " | " << store.name() << " size: "
+                     << store.size() << endl;
+            }
+        }
+
+        colors = colorPattern(guess, targetWord);
+
+        if (colors == "ggggg") {
+            cout << "Using a " << store.name() << ", the program found the word \"" << targetWord << "\" in "
+                 << store.wordsChecked() << " words." << endl;
+            return true;
+        }
+
+        if (store.size() == 0) {
+            cout << "Using a " << store.name() << ", the program did not find the word \"" << targetWord << "\" in "
+                 << store.wordsChecked() << " words." << endl;
+            return false;
+        }
+
+        // Filter the store based on the guess and colors
+        store.filter(guess, colors);
+    }
+}
@@ -0,0 +1,216 @@
+#ifndef ASSIGNMENT_4_WORDSTORE_H
+#define ASSIGNMENT_4_WORDSTORE_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <atomic>
+
+#include "Trie.h"
+#include "WordIndex.h"
+
+using namespace std;
+
+// list_counter should be incremented by one after
+// each word is checked in the 'filterWordList' function.
+extern int list_counter;
+// sorted_counter should be incremented by one after
+// each word is checked in the SortedWordStore 'filter' function.
+extern int sorted_counter;
+
+//returns the colour pattern the game shows for guess when the answer is target
+//g - same letter at the same position, y - letter is somewhere in target, b - letter is not in target
+string colorPattern(const string& guess, const string& target);
+
+//returns true if word is still a possible answer after guess was shown with pattern
+bool matchesPattern(const string& word, const string& guess, const string& pattern);
+
+//returns the words of wordList that match the guess and colors
+list<string> filterWordList(const list<string>& wordList, const string& guess, const string& colors);
+
+//a 5-letter lowercase word packed into 25 bits, 5 bits per letter.
+//the first letter is kept in the highest bits, so packed words sort in the same order as the strings
+typedef uint32_t PackedWord;
+
+//returns true if word has 5 letters from 'a' to 'z'
+bool isPackable(const string& word);
+
+//packs a word, word must be packable
+PackedWord packWord(const string& word);
+
+//turns a packed word back into a string
+string unpackWord(PackedWord packed);
+
+//returns the letter (0 - 25) at position (0 - 4) of a packed word
+inline unsigned int packedLetter(PackedWord packed, int position) {
+    return (packed >> (5 * (4 - position))) & 31u;
+}
+
+//PackedMatcher checks packed words against a TrieQuery with bit operations.
+//"at least once" and "never" are letter masks, only other count bounds need counting.
+class PackedMatcher {
+private:
+    uint32_t allowed[5];
+    uint32_t needed;
+    uint32_t banned;
+    unsigned int counted[26];
+    int countedLetters;
+    unsigned char minCount[26];
+    unsigned char maxCount[26];
+public:
+    explicit PackedMatcher(const TrieQuery& query);
+
+    //returns true if the packed word matches the query
+    bool matches(PackedWord packed) const {
+        unsigned int letters[5];
+        uint32_t contains = 0;
+        uint32_t fits = 1;
+        for (int i = 0; i < 5; ++i) {
+            letters[i] = packedLetter(packed, i);
+            contains |= 1u << letters[i];
+            fits &= allowed[i] >> letters[i];
+        }
+        if (!(fits & 1) || (contains & needed) != needed || (contains & banned) != 0) {
+            return false;
+        }
+        for (int c = 0; c < countedLetters; ++c) {
+            unsigned int letter = counted[c];
+            int count = (letters[0] == letter) + (letters[1] == letter) + (letters[2] == letter) +
+                        (letters[3] == letter) + (letters[4] == letter);
+            if (count < minCount[letter] || count > maxCount[letter]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+//keeps only the words that match the query, in place and in the same order
+void filterPackedWords(vector<PackedWord>& words, const TrieQuery& query);
+
+//replaces to with the words of from that match the query, in the same order
+//to keeps its capacity, so reusing it for many calls does not allocate
+void copyMatchingWords(const vector<PackedWord>& from, const TrieQuery& query, vector<PackedWord>& to);
+
+//returns the position of the word whose different letters appear in the most words, the first one on a tie.
+//this is the hint the interactive helper suggests and the solver choice the game log replay compares with.
+//returns words.size() if words is empty, or if cancelled is given and becomes true while scoring
+size_t bestHintIndex(const vector<PackedWord>& words, const atomic<bool>* cancelled = nullptr);
+
+//WordStore is the pool of candidate words the game loop guesses from.
+//The game loop only talks to this interface, so the data structure behind it can be swapped.
+class WordStore {
+public:
+    virtual ~WordStore() {}
+
+    //inserts a given word to the store
+    //weight is the frequency or prior of the word. Backends that do not rank words ignore it
+    //returns false if word is already in the store or the length of word is not 5
+    virtual bool insert(const string& word, double weight = 1.0) = 0;
+
+    //inserts many words at once. Backends that can build faster from a batch override this
+    virtual void load(const list<string>& words);
+
+    //removes all words that do not match the guess and pattern
+    //returns false if length of inputs is not 5
+    virtual bool filter(const string& guess, const string& pattern) = 0;
+
+    //returns the number of words in the store
+    virtual unsigned int size() const = 0;
+
+    //returns the first word of the store, or empty string if the store is empty
+    virtual string getFirstWord() = 0;
+
+    //returns the word the game should guess next. By default it is the first word
+    virtual string getBestWord();
+
+    //calls visit for every word in the store
+    virtual void forEach(const function<void(const string&)>& visit) const = 0;
+
+    //number of words checked by filter so far
+    virtual int wordsChecked() const = 0;
+
+    //name of the backend, used in the game output
+    virtual string name() const = 0;
+};
+
+//WordStore backed by the Trie. It does not own the trie.
+class TrieWordStore : public WordStore {
+private:
+    Trie& trie;
+public:
+    explicit TrieWordStore(Trie& trie);
+
+    //passes the weight on to the trie, getBestWord ranks by it
+    bool insert(const string& word, double weight = 1.0) override;
+    bool filter(const string& guess, const string& pattern) override;
+    unsigned int size() const override;
+    string getFirstWord() override;
+    //returns the word with the largest weight
+    string getBestWord() override;
+    void forEach(const function<void(const string&)>& visit) const override;
+    int wordsChecked() const override;
+    string name() const override;
+};
+
+//WordStore backed by a linked list, filtered with filterWordList.
+class ListWordStore : public WordStore {
+private:
+    list<string> words;
+public:
+    ListWordStore();
+    explicit ListWordStore(const list<string>& words);
+
+    //the list keeps no weights, weight is ignored
+    bool insert(const string& word, double weight = 1.0) override;
+    //appends the whole batch and drops repeated words once, keeping the first of each
+    void load(const list<string>& words) override;
+    bool filter(const string& guess, const string& pattern) override;
+    unsigned int size() const override;
+    string getFirstWord() override;
+    void forEach(const function<void(const string&)>& visit) const override;
+    int wordsChecked() const override;
+    string name() const override;
+};
+
+//WordStore backed by a sorted contiguous array of packed words.
+//Green letters at the start of the guess form a prefix, so the matching words are one
+//range of the array that is found with binary search. Only that range is checked with a
+//PackedMatcher and the matching words are moved to the front of the array in place.
+class SortedWordStore : public WordStore {
+private:
+    vector<PackedWord> words;
+
+    //returns the range [first, last) of words starting with the first prefixLength letters of prefix
+    void prefixRange(PackedWord prefix, int prefixLength, size_t& first, size_t& last) const;
+public:
+    SortedWordStore();
+    //words must be sorted and must not repeat
+    explicit SortedWordStore(const vector<PackedWord>& sortedWords);
+
+    //the array keeps no weights, weight is ignored
+    bool insert(const string& word, double weight = 1.0) override;
+    //sorts the whole batch once instead of inserting words one by one
+    void load(const list<string>& words) override;
+    bool filter(const string& guess, const string& pattern) override;
+    unsigned int size() const override;
+    string getFirstWord() override;
+    void forEach(const function<void(const string&)>& visit) const override;
+    int wordsChecked() const override;
+    string name() const override;
+
+    //returns the packed words in sorted order
+    const vector<PackedWord>& packedWords() const;
+};
+
+//simulates the Wordle game on any WordStore and displays the number of words checked.
+//returns true if the target word was found.
+//if a dictionary is given, a first guess that is not in it is rejected before it reaches filter.
+//the following guesses come from the store itself, so they are not checked again: the store may keep
+//words the dictionary does not, e.g. a trie loaded with words that have uppercase letters
+//verbose prints the first guess and every following guess with the colors and the size of the store
+bool StoreGamePlay(const string& targetWord, const string& firstGuess, WordStore& store,
+                   const WordIndex* dictionary = nullptr, bool verbose = false);
+#endif
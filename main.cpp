@@ -2,8 +2,19 @@
 #include <string>
 #include <fstream>
 #include <list>
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cctype>
 
 #include "Trie.h"
+#include "WordStore.h"
+#include "WordIndex.h"
+#include "SpeculativeGame.h"
+#include "GameLog.h"
 
 using namespace std;
 
@@ -14,14 +25,17 @@ using namespace std;
     if ((T))            \
         return false;
 
-int list_counter = 0;
+extern int list_counter; // implemented in WordStore.cpp
 extern int trie_counter; // You should implement in Trie.cpp
 
-void TrieGamePlay(string targetWord, string firstGuess, Trie& trie);
-void ListGamePlay(string targetWord, string firstGuess, list<string> wordList);
-list<string> filterWordList(const list<string>& wordList, const string& guess, const string& colors);
+void TrieGamePlay(string targetWord, string firstGuess, Trie& trie, const WordIndex* dictionary = nullptr);
+void ListGamePlay(string targetWord, string firstGuess, list<string> wordList, const WordIndex* dictionary = nullptr);
+void InteractiveGamePlay(const SortedWordStore& words, const WordIndex& dictionary);
+void QueryBenchmark(const Trie& trie, const list<string>& wordList);
 void readWordTrie(const std::string& filename, Trie& trie);
+void readWordTrie(std::istream& in, Trie& trie);
 void readWordList(const std::string& filename, std::list<std::string>& wordList);
+bool readWeight(std::istream& in, double& weight);
 
 string get_status_str(bool status) {
     return status ? "PASSED" : "FAILED";
@@ -29,13 +43,19 @@ string get_status_str(bool status) {
 
 class TrieTest {
 private:
-    bool test_result[5] = {0,0,0,0,0};
-    string test_description[8] = {
+    bool test_result[11] = {0,0,0,0,0,0,0,0,0,0,0};
+    string test_description[11] = {
             "Test1: New trie is valid",
             "Test2: Inserting new words is successful",
             "Test3: Inserting invalid words does not add words",
             "Test4: Filtering updates a trie to a correct filtered trie",
             "Test5: Filtering returns false if inputs are incorrect and does not update a trie",
+            "Test6: All WordStore backends keep the same words after filtering",
+            "Test7: Membership checks find exactly the dictionary words",
+            "Test8: Speculative game gives the same candidates as filtering",
+            "Test9: Top-k returns the heaviest words, also after filtering",
+            "Test10: Queries find the same words as filtering and do not change the trie",
+            "Test11: Replaying game logs checks feedback and counts candidates",
     };
 
 public:
@@ -48,10 +68,16 @@ public:
     bool test3();
     bool test4();
     bool test5();
+    bool test6();
+    bool test7();
+    bool test8();
+    bool test9();
+    bool test10();
+    bool test11();
 };
 
 
-int main() {
+int main(int argc, char* argv[]) {
     // //wordilist.txt has a lot of words. readWordTrie function
     // //may help you create a trie with a lot of words to test.
     // Trie trie;
@@ -111,17 +137,45 @@ int main() {
     readWordList("../wordlist.txt", wordList);
 
 
-    // Run both simulations
-    ListGamePlay(target, startingGuess, wordList);
+    // Build the sorted array and the dictionary index from the same words
+    SortedWordStore sortedStore;
+    sortedStore.load(wordList);
+    WordIndex dictionary(wordList);
 
-    TrieGamePlay(target, startingGuess, gametrie);
+    // "play" starts an interactive game instead of the simulations
+    if (argc > 1 && string(argv[1]) == "play") {
+        InteractiveGamePlay(sortedStore, dictionary);
+        return 0;
+    }
+
+    // "bench" measures the read-only trie queries instead of running the simulations
+    if (argc > 1 && string(argv[1]) == "bench") {
+        QueryBenchmark(gametrie, wordList);
+        return 0;
+    }
+
+    // "replay" followed by log files replays played games and prints their statistics
+    if (argc > 1 && string(argv[1]) == "replay") {
+        vector<string> logs(argv + 2, argv + argc);
+        auto start = chrono::steady_clock::now();
+        ReplayStats stats = replayLogs(logs, sortedStore, dictionary, max(1u, thread::hardware_concurrency()));
+        stats.print(cout, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        return 0;
+    }
+
+    // Run all simulations
+    ListGamePlay(target, startingGuess, wordList, &dictionary);
+
+    TrieGamePlay(target, startingGuess, gametrie, &dictionary);
+
+    StoreGamePlay(target, startingGuess, sortedStore, &dictionary);
 
     return 0;
 }
 
 
 string TrieTest::getTestDescription(int test_num) {
-    if (test_num < 1 || test_num > 5) {
+    if (test_num < 1 || test_num > 11) {
         return "";
     }
     return test_description[test_num-1];
@@ -133,12 +187,18 @@ void TrieTest::runAllTests() {
     test_result[2] = test3();
     test_result[3] = test4();
     test_result[4] = test5();
+    test_result[5] = test6();
+    test_result[6] = test7();
+    test_result[7] = test8();
+    test_result[8] = test9();
+    test_result[9] = test10();
+    test_result[10] = test11();
 }
 
 void TrieTest::printReport() {
     cout << "  TRIE TEST RESULTS  \n"
          << " ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ \n";
-    for (int idx = 0; idx < 5; ++idx) {
+    for (int idx = 0; idx < 11; ++idx) {
         cout << test_description[idx] << "\n  " << get_status_str(test_result[idx]) << endl << endl;
     }
     cout << endl;
@@ -284,9 +344,314 @@ bool TrieTest::test5() {
     return true;
 }
 
+// Test 6: All WordStore backends keep the same words after filtering
+bool TrieTest::test6() {
+    Trie trie;
+    TrieWordStore trieStore(trie);
+    ListWordStore listStore;
+    SortedWordStore sortedStore;
+    WordStore* stores[3] = {&trieStore, &listStore, &sortedStore};
+
+    list<string> words = {"swing", "mango", "thing", "cling", "peach", "sling", "shine", "stink"};
+    for (WordStore* store : stores) {
+        store->load(words);
+        ASSERT_TRUE(store->size() == 8);
+        // duplicates and invalid words are rejected
+        ASSERT_FALSE(store->insert("swing"));
+        ASSERT_FALSE(store->insert("app"));
+        // a second batch with repeated and invalid words adds nothing
+        store->load({"swing", "peach", "app", "peach"});
+        ASSERT_TRUE(store->size() == 8);
+    }
+
+    // leading green letters exercise the prefix range of the sorted array
+    ASSERT_TRUE(sortedStore.filter("sling", "gbggg"));
+    ASSERT_TRUE(sortedStore.size() == 1);
+    ASSERT_TRUE(sortedStore.getFirstWord() == "swing");
+
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(stores[i]->filter("sling", "gbggg"));
+    }
+    for (WordStore* store : stores) {
+        list<string> left;
+        store->forEach([&left](const string& w) { left.push_back(w); });
+        ASSERT_TRUE(left.size() == 1);
+        ASSERT_TRUE(left.front() == "swing");
+    }
+
+    ASSERT_FALSE(sortedStore.filter("sling", "gg"));
+    ASSERT_TRUE(sortedStore.size() == 1);
+
+    return true;
+}
+
+// Test 7: Membership checks find exactly the dictionary words
+bool TrieTest::test7() {
+    list<string> words = {"apple", "mango", "zzzzz", "aaaaa", "apple", "Mango", "app"};
+    WordIndex dictionary(words);
+    Trie trie;
+    for (const string& w : words) {
+        trie.insert(w);
+    }
+
+    // duplicates and words that are not 5 lowercase letters are not counted
+    ASSERT_TRUE(dictionary.size() == 4);
+
+    ASSERT_TRUE(dictionary.contains("apple"));
+    ASSERT_TRUE(dictionary.contains("zzzzz"));
+    ASSERT_TRUE(dictionary.contains("aaaaa"));
+    ASSERT_FALSE(dictionary.contains("apply"));
+    ASSERT_FALSE(dictionary.contains("Mango"));
+    ASSERT_FALSE(dictionary.contains("app"));
+    ASSERT_FALSE(dictionary.contains(""));
+
+    ASSERT_TRUE(trie.contains("apple"));
+    ASSERT_TRUE(trie.contains("Mango"));
+    ASSERT_FALSE(trie.contains("apply"));
+    ASSERT_FALSE(trie.contains("appl"));
+
+    // filtered words are no longer in the trie
+    ASSERT_TRUE(trie.filter("apple", "ggggg"));
+    ASSERT_TRUE(trie.contains("apple"));
+    ASSERT_FALSE(trie.contains("mango"));
+
+    // the trie keeps "Cosed", the dictionary does not. The game may still guess it from its own words,
+    // only the first guess from outside is checked
+    Trie gameTrie;
+    istringstream wordFile("apple mango Cosed 100 peach");
+    readWordTrie(wordFile, gameTrie);
+    list<string> gameWords = {"apple", "mango", "Cosed", "peach"};
+    WordIndex gameDictionary(gameWords);
+    ASSERT_FALSE(gameDictionary.contains("Cosed"));
+    TrieWordStore store(gameTrie);
+    ASSERT_FALSE(StoreGamePlay("Cosed", "zzzzz", store, &gameDictionary));
+    ASSERT_TRUE(gameTrie.size() == 4);
+    ASSERT_TRUE(StoreGamePlay("Cosed", "apple", store, &gameDictionary));
+
+    return true;
+}
+
+// Test 8: Speculative game gives the same candidates as filtering
+bool TrieTest::test8() {
+    list<string> words = {"swing", "mango", "thing", "cling", "peach", "sling", "shine", "stink", "bring"};
+    SortedWordStore store;
+    store.load(words);
+    WordIndex dictionary(words);
+
+    // only the hint of the largest group is scored in the background
+    SpeculativeGame game(store, &dictionary, 1);
+    ASSERT_TRUE(game.size() == 9);
+    ASSERT_TRUE(game.hint().size() == 5);
+
+    // guesses outside the dictionary and feedback without a guess are rejected
+    ASSERT_FALSE(game.guess("zzzzz"));
+    ASSERT_FALSE(game.feedback("bbggg"));
+
+    // "bbggg" is the pattern most candidates give for "cling"
+    ASSERT_TRUE(game.guess("cling"));
+    game.speculation.wait();
+
+    // patterns with other letters are rejected and the guess stays pending
+    ASSERT_FALSE(game.feedback("bbbXb"));
+    ASSERT_FALSE(game.feedback("BBGGG"));
+    ASSERT_FALSE(game.feedback("bbgg"));
+    ASSERT_TRUE(game.size() == 9);
+    ASSERT_TRUE(game.speculationHits() == 0);
+
+    ASSERT_TRUE(game.feedback("bbggg"));
+    ASSERT_TRUE(game.speculationHits() == 1);
+
+    SortedWordStore expected(store.packedWords());
+    expected.filter("cling", "bbggg");
+    ASSERT_TRUE(game.size() == expected.size());
+    ASSERT_TRUE(game.hint() == SpeculativeGame(expected).hint());
+
+    // "ggggg" is the smaller group of "thing", it is reused and only its hint is scored now
+    ASSERT_TRUE(game.guess("thing"));
+    game.speculation.wait();
+    ASSERT_TRUE(game.feedback("ggggg"));
+    ASSERT_TRUE(game.speculationHits() == 2);
+    ASSERT_TRUE(game.size() == 1);
+    ASSERT_TRUE(game.hint() == "thing");
+
+    // a pattern no candidate gives leaves no candidates
+    ASSERT_TRUE(game.guess("cling"));
+    game.speculation.wait();
+    ASSERT_TRUE(game.feedback("yyyyy"));
+    ASSERT_TRUE(game.speculationHits() == 3);
+    ASSERT_TRUE(game.size() == 0);
+    ASSERT_TRUE(game.hint() == "");
+
+    return true;
+}
+
+// Test 9: Top-k returns the heaviest words, also after filtering
+bool TrieTest::test9() {
+    Trie trie;
+
+    ASSERT_TRUE(trie.insert("swing", 5));
+    ASSERT_TRUE(trie.insert("mango", 40));
+    ASSERT_TRUE(trie.insert("thing", 30));
+    ASSERT_TRUE(trie.insert("cling", 10));
+    ASSERT_TRUE(trie.insert("peach", 20));
+    // a duplicate does not change the weight
+    ASSERT_FALSE(trie.insert("swing", 100));
+
+    ASSERT_TRUE(trie.root->maxWeight == 40);
+    ASSERT_TRUE(trie.getBestWord() == "mango");
+
+    list<string> best = trie.topK(3);
+    list<string> expected = {"mango", "thing", "peach"};
+    ASSERT_TRUE(best == expected);
+
+    // asking for more words than the trie has returns all of them
+    ASSERT_TRUE(trie.topK(10).size() == 5);
+    ASSERT_TRUE(trie.topK(0).empty());
+
+    // filtering removes "mango" and "peach", the weights above them must follow
+    ASSERT_TRUE(trie.filter("swing", "bbggg"));
+    ASSERT_TRUE(trie.root->maxWeight == 30);
+    expected = {"thing", "cling"};
+    ASSERT_TRUE(trie.topK(5) == expected);
+
+    Trie empty;
+    ASSERT_TRUE(empty.getBestWord() == "");
+
+    // weights given through the WordStore interface reach the trie
+    TrieWordStore trieStore(empty);
+    ASSERT_TRUE(trieStore.insert("apple", 2));
+    ASSERT_TRUE(trieStore.insert("zesty", 9));
+    ASSERT_TRUE(trieStore.insert("mango"));
+    ASSERT_TRUE(trieStore.getBestWord() == "zesty");
+    SortedWordStore sortedStore;
+    ASSERT_TRUE(sortedStore.insert("zesty", 9));
+    ASSERT_TRUE(sortedStore.insert("apple", 2));
+    ASSERT_TRUE(sortedStore.getBestWord() == "apple");
+
+    // negative weights keep their order
+    Trie negative;
+    ASSERT_TRUE(negative.insert("apple", -3));
+    ASSERT_TRUE(negative.insert("angle", -1));
+    ASSERT_TRUE(negative.insert("mango", -2));
+    expected = {"angle", "mango", "apple"};
+    ASSERT_TRUE(negative.topK(3) == expected);
+
+    // several words on one line are all read, with or without a frequency
+    Trie loaded;
+    istringstream wordFile("apple 3 mango\nangle -1.5 peach 7\ngrape");
+    readWordTrie(wordFile, loaded);
+    ASSERT_TRUE(loaded.size() == 5);
+    list<string> all = loaded.topK(5);
+    ASSERT_TRUE(all.front() == "peach" && all.back() == "angle");
+
+    return true;
+}
+
+// Test 10: Queries find the same words as filtering and do not change the trie
+bool TrieTest::test10() {
+    Trie trie;
+    list<string> words = {"swing", "mango", "thing", "cling", "peach", "sling", "shine", "stink", "spire", "smite"};
+    for (const string& w : words) {
+        ASSERT_TRUE(trie.insert(w));
+    }
+
+    // "s?i?e", must contain r, must not contain a or t
+    TrieQuery query;
+    ASSERT_TRUE(query.setPositions("s?i?e"));
+    query.mustContain('r');
+    query.mustNotContain('a');
+    query.mustNotContain('t');
+    list<string> found;
+    ASSERT_TRUE(trie.query(query, [&found](const string& w) { found.push_back(w); return true; }) == 1);
+    ASSERT_TRUE(found.size() == 1 && found.front() == "spire");
+    ASSERT_TRUE(query.matches("spire"));
+    ASSERT_FALSE(query.matches("smite"));
+
+    // invalid masks are rejected
+    ASSERT_FALSE(query.setPositions("s?i?"));
+    ASSERT_FALSE(query.setPositions("s*i?e"));
+
+    // a letter needed twice prunes words that have it once
+    TrieQuery twice;
+    twice.mustContain('i');
+    twice.mustContain('n', 1);
+    twice.mustContain('s', 2);
+    ASSERT_TRUE(trie.count(twice) == 0);
+
+    // returning false from visit stops the query
+    unsigned int visited = trie.query(TrieQuery(), [](const string&) { return false; });
+    ASSERT_TRUE(visited == 1);
+
+    // feedback queries match the words filter keeps, and the trie still has all words
+    TrieQuery feedback;
+    ASSERT_TRUE(feedback.addFeedback("swing", "bbggg"));
+    ASSERT_FALSE(feedback.addFeedback("swing", "bb"));
+    ASSERT_TRUE(trie.count(feedback) == 2);
+    ASSERT_TRUE(trie.size() == 10);
+
+    ASSERT_TRUE(trie.filter("swing", "bbggg"));
+    for (const string& w : trie.getAllWords()) {
+        ASSERT_TRUE(feedback.matches(w));
+    }
+    ASSERT_TRUE(trie.size() == 2);
+
+    return true;
+}
+
+// Test 11: Replaying game logs checks feedback and counts candidates
+bool TrieTest::test11() {
+    list<string> words = {"swing", "mango", "thing", "cling", "peach", "sling", "shine", "stink"};
+    SortedWordStore store;
+    store.load(words);
+    WordIndex dictionary(words);
+
+    GameReplayer first(store, dictionary);
+    first.replay("thing swing bbggg cling bbggg thing ggggg");
+    // "ybbbb" is not what "peach" gets for the answer "mango"
+    first.replay("mango peach ybbbb mango ggggg");
+    ASSERT_TRUE(first.stats.games == 2);
+    ASSERT_TRUE(first.stats.solvedGames == 2);
+    ASSERT_TRUE(first.stats.inconsistentGames == 1);
+    ASSERT_TRUE(first.stats.guesses == 5);
+    ASSERT_TRUE(first.stats.candidatesAfterGuess.size() == 3);
+    // "swing" leaves thing and cling, "peach" with ybbbb leaves none
+    ASSERT_TRUE(first.stats.candidatesAfterGuess[0] == 2);
+    ASSERT_TRUE(first.stats.candidatesAfterGuess[1] == 1);
+    ASSERT_TRUE(first.stats.gamesAfterGuess[2] == 1);
+    // the solver opens with "sling", then suggests "cling" (tied with "thing", first wins) and "thing"
+    ASSERT_TRUE(first.stats.solverAgreements == 2);
+    ASSERT_TRUE(first.stats.consistentGuesses == 4);
+
+    // blank lines, unknown answers and bad guesses
+    GameReplayer second(store, dictionary);
+    second.replay("");
+    second.replay("zzzzz swing bbbbb");
+    second.replay("shine abc bbbbb");
+    second.replay("shine qqqqq bbbbb");
+    // "sling" covers the most common letters, it is the solver's first guess although "cling" sorts first
+    second.replay("sling sling ggggg");
+    ASSERT_TRUE(second.stats.games == 3);
+    ASSERT_TRUE(second.stats.malformedLines == 2);
+    ASSERT_TRUE(second.stats.invalidGuesses == 1);
+    ASSERT_TRUE(second.stats.solvedGames == 1);
+    ASSERT_TRUE(second.stats.solverAgreements == 1);
+
+    ReplayStats total;
+    total.merge(first.stats);
+    total.merge(second.stats);
+    ASSERT_TRUE(total.games == 5);
+    ASSERT_TRUE(total.guesses == 7);
+    ASSERT_TRUE(total.gamesAfterGuess[0] == 4);
+
+    // the replay never changes the shared words
+    ASSERT_TRUE(store.size() == 8);
+
+    return true;
+}
+
 /*
 Similar to the ‘ListGamePlay’ function, the ‘TrieGamePlay’ function simulates the Wordle
-game but uses a Trie instead of a List. Given three parameters, it iteratively guesses a
+game but uses a Trie instead of a List. Given its parameters, it iteratively guesses a
 word from the pool of words and uses the feedback to refine its guesses until the target
 word is found. After the target word is found, the program displays the total number of
 words checked along the process, which is tracked by the global variable ‘trie_counter’.
@@ -309,10 +674,11 @@ By checking the ‘filterWordList’ function in ‘main.cpp’, you can see how
 implemented. You will need to implement ‘trie_counter’ in a similar way, incrementing it
 by one after each word is checked along the process to find the answer to the question.
 
-The following are the three parameters the function, ‘TrieGamePlay’, takes in:
+The following are the parameters the function, ‘TrieGamePlay’, takes in:
 string targetWord - This is the Wordle answer the program aims to guess.
 string firstGuess - This is a random 5-letter word used as the initial guess.
 Trie& trie - This is a trie of all the words from ‘wordlist.txt’.
+const WordIndex* dictionary - If given, a guess that is not in it is rejected before it reaches filter.
 
 Output:
 Using a Trie, the program found the word “scent” in ___ words.
@@ -321,126 +687,155 @@ Note: In the output, the number of words checked is left blank. Once you success
 implement the functions in the Trie class, you will notice a significant difference
 between using a list and a trie.
 */
-void TrieGamePlay(string targetWord, string firstGuess, Trie& trie) {
-    int attemptsTrie = 0;
-    cout << "first guess: " << firstGuess << endl;
-    string guess, colors;
-    while (true) {
-        attemptsTrie++;
-        if (attemptsTrie == 1) {
-            guess = firstGuess;
-        } else {
-            guess = trie.getFirstWord(); // The programs' guess is the first word in the trie
-            cout << guess << endl;
-            cout << "Guess: " << guess << " | Colors: " << colors << " | Trie size: " << trie.size() << endl;
-        }
+void TrieGamePlay(string targetWord, string firstGuess, Trie& trie, const WordIndex* dictionary) {
+    TrieWordStore store(trie);
+    StoreGamePlay(targetWord, firstGuess, store, dictionary, true);
+}
 
-        // Compare the program guess and target word to determine the color code
-        colors = "";
-        for (int i = 0; i < 5; ++i) {
-            if (guess[i] == targetWord[i]) {
-                colors += 'g'; // Green
-            } else if (targetWord.find(guess[i]) != string::npos) {
-                colors += 'y'; // Yellow
-            } else {
-                colors += 'b'; // Grey
-            }
-        }
+// This function simulates the Wordle game using Lists and displays the number of words checked.
+// If a dictionary is given, a guess that is not in it is rejected before it reaches filter.
+void ListGamePlay(string targetWord, string firstGuess, list<string> wordList, const WordIndex* dictionary) {
+    ListWordStore store(wordList);
+    StoreGamePlay(targetWord, firstGuess, store, dictionary);
+}
 
-        if (colors == "ggggg") {
-            cout << "Using a Trie, the program found the word \"" << targetWord << "\" in " << trie_counter << " words."
-                 << endl;
-            break;
+// This function lets a player use the program as a helper during a real game.
+// The program shows a hint, the player types the guess they made and the colors the game showed.
+// While the player is typing the colors, the next candidates are prepared in the background.
+void InteractiveGamePlay(const SortedWordStore& words, const WordIndex& dictionary) {
+    SpeculativeGame game(words, &dictionary);
+    string guess, colors;
+    while (game.size() > 0) {
+        cout << "Hint: " << game.hint() << " | Candidates: " << game.size() << endl;
+
+        cout << "Guess: ";
+        if (!(cin >> guess)) break;
+        if (!game.guess(guess)) {
+            cout << "\"" << guess << "\" is not a valid word." << endl;
+            continue;
         }
 
-        if(trie.size() == 0){
-            cout << "Using a Trie, the program did not find the word \"" << targetWord << "\" in " << trie_counter << " words."
-                 << endl;
-            break;
+        // ask for the colors of the same guess until they are valid
+        bool accepted = false;
+        while (!accepted) {
+            cout << "Colors: ";
+            if (!(cin >> colors)) break;
+            if (colors == "ggggg") {
+                cout << "Solved with \"" << guess << "\"." << endl;
+                return;
+            }
+            accepted = game.feedback(colors);
+            if (!accepted) {
+                cout << "Colors must have 5 letters, each g, y or b." << endl;
+            }
         }
-
-        // Filter the trie based on the guess and colors
-        trie.filter(guess, colors);
+        if (!accepted) break;
+    }
+    if (game.size() == 0) {
+        cout << "No candidates left." << endl;
     }
+    cout << game.speculationHits() << " answers were prepared in the background." << endl;
 }
 
-// This function simulates the Wordle game using Lists and displays the number of words checked.
-void ListGamePlay(string targetWord, string firstGuess, list<string> wordList) {
-    int attemptsList = 0;
-    string guess, colors;
-    while (true) {
-        attemptsList++;
-        if (attemptsList == 1) {
-            guess = firstGuess;
-        } else {
-            guess = wordList.front(); // The programs' guess is the first word in the list
-        }
+// This function measures how many read-only queries per second the trie answers.
+// Each query is the feedback of two random guesses for a random answer, like in the middle of a game.
+// The queries run on one thread first and then on all cores sharing the same trie.
+void QueryBenchmark(const Trie& trie, const list<string>& wordList) {
+    vector<string> words(wordList.begin(), wordList.end());
+    if (words.empty()) {
+        cout << "No words to query." << endl;
+        return;
+    }
 
-        // Compare the program guess and target word to determine the color code
-        colors = "";
-        for (int i = 0; i < 5; ++i) {
-            if (guess[i] == targetWord[i]) {
-                colors += 'g'; // Green
-            } else if (targetWord.find(guess[i]) != string::npos) {
-                colors += 'y'; // Yellow
-            } else {
-                colors += 'b'; // Grey
-            }
+    // build the queries before the timing starts
+    const int QUERY_COUNT = 100000;
+    mt19937 random(2024);
+    uniform_int_distribution<size_t> pick(0, words.size() - 1);
+    vector<TrieQuery> queries(QUERY_COUNT);
+    for (TrieQuery& query : queries) {
+        const string& target = words[pick(random)];
+        for (int guesses = 0; guesses < 2; ++guesses) {
+            const string& guess = words[pick(random)];
+            query.addFeedback(guess, colorPattern(guess, target));
         }
+    }
 
-        if (colors == "ggggg") {
-            cout << "Using a List, the program found the word \"" << targetWord << "\" in " << list_counter << " words." << endl;
-            break;
+    vector<unsigned int> threadCounts = {1};
+    if (thread::hardware_concurrency() > 1) {
+        threadCounts.push_back(thread::hardware_concurrency());
+    }
+    for (unsigned int threadCount : threadCounts) {
+        vector<unsigned long> matches(threadCount, 0);
+        vector<thread> workers;
+        auto start = chrono::steady_clock::now();
+        for (unsigned int t = 0; t < threadCount; ++t) {
+            workers.emplace_back([&, t]() {
+                // sum locally, neighbouring elements of matches share a cache line
+                unsigned long found = 0;
+                for (size_t idx = t; idx < queries.size(); idx += threadCount) {
+                    found += trie.count(queries[idx]);
+                }
+                matches[t] = found;
+            });
         }
-
-        if(wordList.empty()){
-            cout << "Using a List, the program did not find the word \"" << targetWord << "\" in " << list_counter << " words." << endl;
-            break;
+        for (thread& worker : workers) {
+            worker.join();
         }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
 
-        // Filter the word list based on the guess and colors
-        wordList = filterWordList(wordList, guess, colors);
+        unsigned long total = 0;
+        for (unsigned long m : matches) {
+            total += m;
+        }
+        cout << "Threads: " << threadCount << " | Queries per second: " << static_cast<long>(QUERY_COUNT / seconds)
+             << " | Average matches: " << static_cast<double>(total) / QUERY_COUNT << endl;
     }
 }
 
-list<string> filterWordList(const list<string>& wordList, const string& guess, const string& colors) {
-    list<string> filteredWords;
-
-    for (const auto& word : wordList) {
-        list_counter ++;
-        bool matches = true;
-        for (int i = 0; i < 5; ++i) {
-            if (colors[i] == 'g' && word[i] != guess[i]) { // Green - correct position
-                matches = false;
-                break;
-            } else if (colors[i] == 'y') { // Yellow - correct letter, wrong position
-                if (word[i] == guess[i] || word.find(guess[i]) == string::npos) { // Checks if the letters are equal or if the letter exists in the word
-                    matches = false;
-                    break;
-                }
-            } else if (colors[i] == 'b' && word.find(guess[i]) != string::npos) { // Grey - letter not in word
-                matches = false;
-                break;
-            }
-        }
-        if (matches) {
-            filteredWords.push_back(word);
-        }
+// Reads the frequency that may follow a word. Words are letters, so a number is told apart by its first character.
+// Returns false and reads nothing if the next token is not a number.
+bool readWeight(std::istream& in, double& weight) {
+    in >> std::ws;
+    int next = in.peek();
+    if (next == EOF || !(isdigit(next) || next == '-' || next == '+' || next == '.')) {
+        return false;
+    }
+    if (!(in >> weight)) {
+        // a token like "-x" is not a number, skip it so the words after it are still read
+        in.clear();
+        std::string skipped;
+        in >> skipped;
+        std::cerr << "Skipping \"" << skipped << "\", it is not a word or a frequency." << std::endl;
+        return false;
     }
-    return filteredWords;
+    return true;
 }
 
+// The file has words separated by white space, each optionally followed by its frequency.
+// Words without a frequency get weight 1.
 void readWordTrie(const std::string& filename, Trie& trie) {
     std::ifstream file(filename);
+    readWordTrie(file, trie);
+}
+
+void readWordTrie(std::istream& in, Trie& trie) {
     std::string word;
-    while (file >> word)
-            trie.insert(word);
+    while (in >> word) {
+        double weight;
+        if (!readWeight(in, weight)) {
+            weight = 1.0;
+        }
+        trie.insert(word, weight);
+    }
 }
 
+// The list keeps only the words, the frequencies are skipped.
 void readWordList(const std::string& filename, std::list<std::string>& wordList) {
     std::ifstream file(filename);
     std::string word;
+    double weight;
     while (file >> word) {
+        readWeight(file, weight);
         if (word.length() == 5) {
             wordList.push_back(word);
         }